@@ -2,6 +2,10 @@
 
 #include <stddef.h>
 
+#ifdef READARG_GETOPT
+#include <getopt.h>
+#endif
+
 #define READARG_STRINGS(...) ((char *[]){__VA_ARGS__, NULL})
 
 enum readarg_error {
@@ -11,6 +15,9 @@ enum readarg_error {
     READARG_ENOTOPT,
     READARG_ERANGEOPT,
     READARG_ERANGEOPER,
+    READARG_EDUPNAME,
+    READARG_ENOSPACE,
+    READARG_EQUOTE,
 };
 
 enum readarg_form {
@@ -36,31 +43,106 @@ struct readarg_arg {
     struct readarg_view_strings val;
 };
 
+struct readarg_map_entry {
+    /* An unused entry has no key. The key is not null-terminated, it ends after keylen characters. */
+    const char *key;
+    size_t keylen;
+    size_t hash;
+    /* Everything after the first '=', or NULL if there was no '='. */
+    const char *val;
+};
+
+/* An open-addressed hash table of key=value pairs, filled from caller-provided entries. */
+struct readarg_map {
+    struct readarg_map_entry *entries;
+    /* The number of entries, which must be a power of two and at least 4. */
+    size_t cap;
+    size_t len;
+    /* Keep the first value of a repeated key instead of the last one. */
+    int first;
+};
+
 struct readarg_opt {
     /* Two null-terminated arrays of either long or short option names. */
     char **names[2];
     struct readarg_arg arg;
+    /* If set, every value of the option is split at the first '=' and added to the map as well. */
+    struct readarg_map *map;
+};
+
+struct readarg_index_slot {
+    /* An unused slot has no name. */
+    const char *name;
+    size_t hash;
+    enum readarg_form form;
+    struct readarg_opt *opt;
+};
+
+/* An open-addressed hash table of option names, filled from caller-provided slots. */
+struct readarg_index {
+    struct readarg_index_slot *slots;
+    /* The number of slots, which must be a power of two and at least 4. */
+    size_t cap;
+    size_t len;
+    /* The length of the longest name of each form, which bounds the lookups. */
+    size_t maxlen[2];
+};
+
+struct readarg_parser_state {
+    int pending;
+    /* Set once "--" has been parsed, after which every argument is an operand. */
+    int eoopts;
+    const char *grppos;
+    struct {
+        struct readarg_opt *opt;
+        /* Reference to the current argument being parsed. */
+        const char **arg;
+        /* Reference to the last element of the option/operand value view. */
+        const char **eoval;
+        /* Intermediate operands which have not yet been assigned. */
+        struct readarg_view_strings ioper;
+    } curr;
 };
 
 struct readarg_parser {
     size_t nopts;
+    /* The number of options opts has room for, which is nopts unless set otherwise. */
+    size_t capopts;
     struct readarg_opt *opts;
+    /* Optional index which replaces the linear search through opts. */
+    struct readarg_index *index;
     size_t nopers;
     struct readarg_arg *opers;
     struct readarg_view_strings args;
+    struct readarg_parser_state state;
+    enum readarg_error error;
+};
+
+/* A snapshot of the parser between two arguments, from which parsing can be resumed. */
+struct readarg_checkpoint {
+    /* Room for the value views of all options, provided by the caller. */
+    struct readarg_view_strings *vals;
+    size_t cap;
+    size_t nopts;
+    struct readarg_parser_state state;
+};
+
+/* Scans a contiguous buffer of null-terminated strings for options without permuting or copying it. */
+struct readarg_scanner {
+    size_t nopts;
+    struct readarg_opt *opts;
+    struct readarg_index *index;
+    /* A buffer such as the contents of /proc/<pid>/cmdline. */
+    const char *buf;
+    size_t len;
     struct {
-        int pending;
+        /* Reference to the next string in the buffer. */
+        const char *pos;
         const char *grppos;
-        struct {
-            struct readarg_opt *opt;
-            /* Reference to the current argument being parsed. */
-            const char **arg;
-            /* Reference to the last element of the option/operand value view. */
-            const char **eoval;
-            /* Intermediate operands which have not yet been assigned. */
-            struct readarg_view_strings ioper;
-        } curr;
     } state;
+    /* The option found by the last call to readarg_scan and its value, if it takes one. */
+    struct readarg_opt *opt;
+    const char *val;
     enum readarg_error error;
 };
 
@@ -74,6 +156,26 @@ struct readarg_helpgen_writer {
 int readarg_parse(struct readarg_parser *rp);
 /* args should always exclude the first element. */
 void readarg_parser_init(struct readarg_parser *rp, struct readarg_opt *opts, size_t nopts, struct readarg_arg *opers, size_t nopers, struct readarg_view_strings args);
+/* Save the parser state. This fails in the middle of grouped options, after an error or if the checkpoint has no room for all options. */
+int readarg_checkpoint_save(struct readarg_parser *rp, struct readarg_checkpoint *cp);
+/* Return to an earlier checkpoint, with args now being len elements long. The elements from cp->state.curr.arg onwards must be written again afterwards. */
+void readarg_checkpoint_restore(struct readarg_parser *rp, const struct readarg_checkpoint *cp, size_t len);
+/* Append options to the parser, which may already be parsing. Nothing is added if any name is already taken. */
+enum readarg_error readarg_parser_add_opts(struct readarg_parser *rp, const struct readarg_opt *opts, size_t nopts);
+/* The slots are cleared here. */
+void readarg_index_init(struct readarg_index *index, struct readarg_index_slot *slots, size_t cap);
+/* Add the names of the options to the index. Nothing is added if any name is already taken by another option. */
+enum readarg_error readarg_index_add(struct readarg_index *index, struct readarg_opt *opts, size_t nopts);
+/* The entries are cleared here. */
+void readarg_map_init(struct readarg_map *map, struct readarg_map_entry *entries, size_t cap, int first);
+/* Look up a key after parsing. NULL is returned if the key was never given. */
+const struct readarg_map_entry *readarg_map_get(const struct readarg_map *map, const char *key);
+/* Split a command line into at most cap tokens in place, removing quotes and backslashes and overwriting separators with null bytes. */
+enum readarg_error readarg_tokenize(char *line, const char **tokens, size_t cap, struct readarg_view_strings *out);
+/* Iteratively scan the buffer for the next option occurrence. Options which are not in opts or which are given a value they do not take are skipped. */
+int readarg_scan(struct readarg_scanner *rs);
+/* The strings in buf should exclude the program name. If the last string is not null-terminated within len, buf[len] must be a null byte. */
+void readarg_scanner_init(struct readarg_scanner *rs, struct readarg_opt *opts, size_t nopts, const char *buf, size_t len);
 /* Output usage information. */
 int readarg_helpgen_put_usage(struct readarg_parser *rp, struct readarg_helpgen_writer *writer, const char *progname, const char *usage);
 /* Assign operands from the operand list to operands defined for the parser. */
@@ -87,6 +189,11 @@ size_t readarg_select_upper(struct readarg_bounds bounds);
 /* Get the lower limit. This does not always return the minimum. */
 size_t readarg_select_lower(struct readarg_bounds bounds);
 
+#ifdef READARG_GETOPT
+/* A drop-in replacement for getopt_long. The options are translated for the matcher whenever optstring or longopts change, and tables with more than READARG_GETOPT_MAX of them are passed on to getopt_long. */
+int readarg_getopt_long(int argc, char *const argv[], const char *optstring, const struct option *longopts, int *longindex);
+#endif
+
 #ifdef READARG_IMPLEMENTATION
 
 #ifdef READARG_DEBUG
@@ -102,6 +209,9 @@ size_t readarg_select_lower(struct readarg_bounds bounds);
     } while (0)
 #define READARG_HELPGEN_TRY_STR(writer, s) READARG_HELPGEN_TRY_BUF((writer), (s), (strlen((s))))
 
+/* The FNV-1a offset basis. */
+#define READARG_HASH_BASIS 2166136261u
+
 #include <assert.h>
 #include <string.h>
 
@@ -110,11 +220,30 @@ static void readarg_parse_arg(struct readarg_parser *rp, const char *arg);
 static void readarg_parse_opt(struct readarg_parser *rp, enum readarg_form form, const char **pos);
 
 static struct readarg_opt *readarg_match_opt(struct readarg_parser *rp, enum readarg_form form, const char **needle);
+static struct readarg_opt *readarg_match_in(struct readarg_opt *opts, size_t nopts, struct readarg_index *index, enum readarg_form form, const char **needle);
+static struct readarg_opt *readarg_index_match(struct readarg_index *index, enum readarg_form form, const char **needle);
+
+static enum readarg_error readarg_index_add_opt(struct readarg_index *index, struct readarg_opt *opt);
+static void readarg_index_drop_opt(struct readarg_index *index, struct readarg_opt *opt);
+static struct readarg_index_slot *readarg_index_probe(struct readarg_index *index, enum readarg_form form, const char *name, size_t len, size_t hash);
+
+static size_t readarg_checkpoint_nvals(const struct readarg_parser_state *state, struct readarg_opt *opt, struct readarg_view_strings val);
+
+static void readarg_map_put(struct readarg_parser *rp, struct readarg_map *map, const char *string);
+static struct readarg_map_entry *readarg_map_probe(const struct readarg_map *map, const char *key, size_t keylen, size_t hash);
+static size_t readarg_map_hash(const char *key, size_t keylen);
+
+static size_t readarg_hash(enum readarg_form form, const char *name, size_t len);
+static size_t readarg_hash_step(size_t hash, unsigned char c);
+
+static const char *readarg_scan_next(struct readarg_scanner *rs);
+
+static int readarg_is_sep(char c);
 
 static void readarg_update_opt(struct readarg_parser *rp, const char *attach, struct readarg_opt *opt);
 static void readarg_update_oper(struct readarg_parser *rp, struct readarg_view_strings val);
 
-static void readarg_add_val(struct readarg_parser *rp, struct readarg_arg *arg, const char *string, int end);
+static void readarg_add_val(struct readarg_parser *rp, struct readarg_opt *opt, const char *string, int end);
 
 static const char *readarg_skip_incl(const char *outer, const char *inner);
 
@@ -136,7 +265,7 @@ int readarg_parse(struct readarg_parser *rp) {
     }
 
     if (rp->state.pending) {
-        readarg_add_val(rp, &rp->state.curr.opt->arg, *rp->state.curr.arg, 0);
+        readarg_add_val(rp, rp->state.curr.opt, *rp->state.curr.arg, 0);
         ++rp->state.curr.arg;
         return !rp->error;
     }
@@ -155,6 +284,7 @@ void readarg_parser_init(struct readarg_parser *rp, struct readarg_opt *opts, si
         .args = args,
         .opts = opts,
         .nopts = nopts,
+        .capopts = nopts,
         .opers = opers,
         .nopers = nopers,
         .state.curr = {
@@ -164,6 +294,292 @@ void readarg_parser_init(struct readarg_parser *rp, struct readarg_opt *opts, si
     };
 }
 
+int readarg_checkpoint_save(struct readarg_parser *rp, struct readarg_checkpoint *cp) {
+    if (rp->state.grppos || rp->error || rp->nopts > cp->cap)
+        return 0;
+
+    for (size_t i = 0; i < rp->nopts; i++)
+        cp->vals[i] = rp->opts[i].arg.val;
+
+    cp->nopts = rp->nopts;
+    cp->state = rp->state;
+
+    return 1;
+}
+
+void readarg_checkpoint_restore(struct readarg_parser *rp, const struct readarg_checkpoint *cp, size_t len) {
+    assert(cp->nopts <= rp->nopts);
+
+    /*
+     * Parsing only ever appends to a view, and the views behind it are shifted towards the end of args while keeping their order.
+     * The values which existed at the checkpoint are therefore still at the start of each view and can be moved back, as long as
+     * the views are processed in ascending order.
+     */
+    const char **done = NULL;
+    for (;;) {
+        const struct readarg_view_strings *from = NULL, *to = NULL;
+        size_t n = 0;
+
+        for (size_t i = 0; i <= cp->nopts; i++) {
+            const struct readarg_view_strings *saved = i < cp->nopts ? &cp->vals[i] : &cp->state.curr.ioper;
+            const struct readarg_view_strings *curr = i < cp->nopts ? &rp->opts[i].arg.val : &rp->state.curr.ioper;
+            size_t nvals = i < cp->nopts ? readarg_checkpoint_nvals(&cp->state, &rp->opts[i], *saved) : saved->len;
+
+            if (!nvals || (done && saved->strings <= done) || (to && saved->strings >= to->strings))
+                continue;
+
+            from = curr, to = saved, n = nvals;
+        }
+
+        if (!to)
+            break;
+
+        memmove(to->strings, from->strings, n * sizeof *to->strings);
+        done = to->strings;
+    }
+
+    for (size_t i = 0; i < rp->nopts; i++) {
+        rp->opts[i].arg.val = i < cp->nopts ? cp->vals[i] : (struct readarg_view_strings){0};
+        if (rp->opts[i].map)
+            readarg_map_init(rp->opts[i].map, rp->opts[i].map->entries, rp->opts[i].map->cap, rp->opts[i].map->first);
+    }
+
+    for (size_t i = 0; i < rp->nopers; i++)
+        rp->opers[i].val = (struct readarg_view_strings){0};
+
+    rp->state = cp->state;
+    rp->error = READARG_ESUCCESS;
+    rp->args.len = len;
+
+    /* Maps cannot be rolled back, so they are filled again from the restored values. */
+    for (size_t i = 0; i < cp->nopts; i++) {
+        struct readarg_opt *opt = &rp->opts[i];
+        if (opt->map) {
+            size_t nvals = readarg_checkpoint_nvals(&rp->state, opt, opt->arg.val);
+            for (size_t j = 0; j < nvals; j++)
+                readarg_map_put(rp, opt->map, opt->arg.val.strings[j]);
+        }
+    }
+}
+
+enum readarg_error readarg_parser_add_opts(struct readarg_parser *rp, const struct readarg_opt *opts, size_t nopts) {
+    if (nopts > rp->capopts - rp->nopts)
+        return READARG_ENOSPACE;
+
+    enum readarg_error error = READARG_ESUCCESS;
+    size_t i;
+    for (i = 0; i < nopts && !error; i++) {
+        struct readarg_opt *opt = rp->opts + rp->nopts + i;
+        *opt = opts[i];
+
+        if (rp->index) {
+            error = readarg_index_add_opt(rp->index, opt);
+            continue;
+        }
+
+        /* Without an index, every name is compared against all of the options which are already there. */
+        for (size_t form = 0; form < sizeof opt->names / sizeof *opt->names && !error; form++) {
+            for (size_t j = 0; opt->names[form] && opt->names[form][j] && !error; j++) {
+                const char *pos = opt->names[form][j];
+                if (readarg_match_in(rp->opts, rp->nopts + i, NULL, form, &pos) && !*pos)
+                    error = READARG_EDUPNAME;
+            }
+        }
+    }
+
+    if (error) {
+        /* The failed option has already dropped its own names. */
+        for (--i; rp->index && i--;)
+            readarg_index_drop_opt(rp->index, rp->opts + rp->nopts + i);
+        return error;
+    }
+
+    rp->nopts += nopts;
+    return READARG_ESUCCESS;
+}
+
+void readarg_index_init(struct readarg_index *index, struct readarg_index_slot *slots, size_t cap) {
+    assert(cap >= 4 && !(cap & (cap - 1)));
+
+    *index = (struct readarg_index){
+        .slots = slots,
+        .cap = cap,
+    };
+
+    memset(slots, 0, cap * sizeof *slots);
+}
+
+enum readarg_error readarg_index_add(struct readarg_index *index, struct readarg_opt *opts, size_t nopts) {
+    for (size_t i = 0; i < nopts; i++) {
+        enum readarg_error error = readarg_index_add_opt(index, opts + i);
+
+        if (error) {
+            while (i--)
+                readarg_index_drop_opt(index, opts + i);
+            return error;
+        }
+    }
+
+    return READARG_ESUCCESS;
+}
+
+void readarg_map_init(struct readarg_map *map, struct readarg_map_entry *entries, size_t cap, int first) {
+    assert(cap >= 4 && !(cap & (cap - 1)));
+
+    *map = (struct readarg_map){
+        .entries = entries,
+        .cap = cap,
+        .first = first,
+    };
+
+    memset(entries, 0, cap * sizeof *entries);
+}
+
+const struct readarg_map_entry *readarg_map_get(const struct readarg_map *map, const char *key) {
+    size_t keylen = strlen(key);
+    struct readarg_map_entry *entry = readarg_map_probe(map, key, keylen, readarg_map_hash(key, keylen));
+    return entry->key ? entry : NULL;
+}
+
+enum readarg_error readarg_tokenize(char *line, const char **tokens, size_t cap, struct readarg_view_strings *out) {
+    /* Tokens only ever shrink, so the unquoted text can be written behind the read position. */
+    char *r = line, *w = line;
+    size_t len = 0;
+
+    *out = (struct readarg_view_strings){.strings = tokens};
+
+    for (;;) {
+        while (readarg_is_sep(*r) || (r[0] == '\\' && r[1] == '\n'))
+            r += *r == '\\' ? 2 : 1;
+
+        if (!*r)
+            break;
+
+        if (len >= cap)
+            return READARG_ENOSPACE;
+
+        tokens[len++] = w;
+
+        char quote = 0;
+        for (; *r && (quote || !readarg_is_sep(*r)); ++r) {
+            if (quote == '\'') {
+                /* Everything is literal within single quotes. */
+                if (*r == '\'')
+                    quote = 0;
+                else
+                    *w++ = *r;
+            } else if (quote == '"') {
+                /* Within double quotes, a backslash only escapes characters which are special there. */
+                if (*r == '"')
+                    quote = 0;
+                else if (*r == '\\' && r[1] == '\n')
+                    ++r;
+                else if (*r == '\\' && r[1] && strchr("\"\\$`", r[1]))
+                    *w++ = *++r;
+                else
+                    *w++ = *r;
+            } else if (*r == '\'' || *r == '"') {
+                quote = *r;
+            } else if (*r == '\\' && r[1] == '\n') {
+                /* A backslash followed by a newline joins the lines. */
+                ++r;
+            } else if (*r == '\\' && r[1]) {
+                *w++ = *++r;
+            } else {
+                *w++ = *r;
+            }
+        }
+
+        if (quote)
+            return READARG_EQUOTE;
+
+        /* The separator has to be skipped before it may be overwritten. */
+        if (*r)
+            ++r;
+        *w++ = '\0';
+    }
+
+    out->len = len;
+    return READARG_ESUCCESS;
+}
+
+int readarg_scan(struct readarg_scanner *rs) {
+    rs->opt = NULL, rs->val = NULL;
+
+    for (;;) {
+        enum readarg_form form = READARG_FORM_SHORT;
+        const char *attach = NULL;
+        const char *pos = rs->state.grppos;
+
+        if (pos) {
+            rs->state.grppos = NULL;
+        } else {
+            pos = readarg_scan_next(rs);
+            if (!pos)
+                return 0;
+
+            if (pos[0] != '-' || pos[1] == '\0')
+                /* Operands are of no interest. */
+                continue;
+
+            ++pos;
+            if (*pos == '-') {
+                ++pos;
+                if (*pos == '\0') {
+                    /* "--" denotes the end of options, so the rest of the buffer does not need to be looked at. */
+                    rs->state.pos = rs->buf + rs->len;
+                    return 0;
+                }
+
+                form = READARG_FORM_LONG;
+            }
+        }
+
+        struct readarg_opt *match = readarg_match_in(rs->opts, rs->nopts, rs->index, form, &pos);
+        if (!match)
+            /* Skip the unknown option along with the rest of its group. */
+            continue;
+
+        if (form == READARG_FORM_LONG) {
+            if (*pos == '=')
+                attach = pos + 1;
+            else if (*pos)
+                continue;
+        } else if (*pos) {
+            if (match->arg.name)
+                attach = pos;
+            else
+                rs->state.grppos = pos;
+        }
+
+        if (!match->arg.name && attach)
+            /* A value given to an option which takes none is skipped like an unknown option, so the rest of the buffer is still scanned. */
+            continue;
+
+        rs->opt = match;
+
+        if (match->arg.name) {
+            rs->val = attach ? attach : readarg_scan_next(rs);
+            if (!rs->val) {
+                rs->error = READARG_ENOVAL;
+                return 0;
+            }
+        }
+
+        return 1;
+    }
+}
+
+void readarg_scanner_init(struct readarg_scanner *rs, struct readarg_opt *opts, size_t nopts, const char *buf, size_t len) {
+    *rs = (struct readarg_scanner){
+        .opts = opts,
+        .nopts = nopts,
+        .buf = buf,
+        .len = len,
+        .state.pos = buf,
+    };
+}
+
 int readarg_helpgen_put_usage(struct readarg_parser *rp, struct readarg_helpgen_writer *writer, const char *progname, const char *usage) {
     READARG_HELPGEN_TRY_STR(writer, usage);
     READARG_HELPGEN_TRY_STR(writer, ":\n");
@@ -363,6 +779,12 @@ static void readarg_parse_arg(struct readarg_parser *rp, const char *arg) {
         return;
     }
 
+    if (rp->state.eoopts) {
+        /* Arguments which have been added behind "--" after it was parsed, e.g. after restoring a checkpoint. */
+        readarg_update_oper(rp, (struct readarg_view_strings){.len = 1, .strings = (const char *[]){arg}});
+        return;
+    }
+
     const char *pos = arg;
 
     switch (*pos) {
@@ -375,6 +797,7 @@ static void readarg_parse_arg(struct readarg_parser *rp, const char *arg) {
                 size_t off;
             case '\0':
                 /* "--" denotes the end of options. */
+                rp->state.eoopts = 1;
                 off = rp->args.len - (rp->state.curr.arg - rp->args.strings);
                 assert(off);
                 if (off == 1)
@@ -447,6 +870,18 @@ static void readarg_parse_opt(struct readarg_parser *rp, enum readarg_form form,
 }
 
 static struct readarg_opt *readarg_match_opt(struct readarg_parser *rp, enum readarg_form form, const char **needle) {
+    struct readarg_opt *match = readarg_match_in(rp->opts, rp->nopts, rp->index, form, needle);
+
+    if (match)
+        rp->state.curr.opt = match;
+
+    return match;
+}
+
+static struct readarg_opt *readarg_match_in(struct readarg_opt *opts, size_t nopts, struct readarg_index *index, enum readarg_form form, const char **needle) {
+    if (index)
+        return readarg_index_match(index, form, needle);
+
     /* This represents the last inexact match. */
     struct {
         /* The current advanced string. */
@@ -455,9 +890,9 @@ static struct readarg_opt *readarg_match_opt(struct readarg_parser *rp, enum rea
         struct readarg_opt *opt;
     } loose = {0};
 
-    for (size_t i = 0; i < rp->nopts; i++) {
+    for (size_t i = 0; i < nopts; i++) {
         /* Iterate through all short or long names of the current option. */
-        char **names = rp->opts[i].names[form];
+        char **names = opts[i].names[form];
 
         if (!names)
             /* Ignore the option as it does not have names in the required form. */
@@ -475,29 +910,221 @@ static struct readarg_opt *readarg_match_opt(struct readarg_parser *rp, enum rea
             if (!*cmp) {
                 /* A guaranteed match. */
                 *needle = cmp;
-                return rp->state.curr.opt = rp->opts + i;
+                return opts + i;
             } else if ((cmp - *needle) > (loose.adv - *needle))
                 /* Maybe a match, maybe not. */
-                loose.adv = cmp, loose.opt = rp->opts + i;
+                loose.adv = cmp, loose.opt = opts + i;
         }
     }
 
     if (loose.adv)
         *needle = loose.adv;
 
-    if (loose.opt)
-        return rp->state.curr.opt = loose.opt;
+    return loose.opt;
+}
 
-    return NULL;
+static struct readarg_opt *readarg_index_match(struct readarg_index *index, enum readarg_form form, const char **needle) {
+    struct readarg_opt *match = NULL;
+    const char *adv = NULL;
+    size_t hash = readarg_hash(form, NULL, 0);
+
+    /*
+     * Every prefix of the needle up to the longest name is looked up, so that the longest matching name wins just like with the
+     * linear search. A long name cannot extend past a '=', since the value starts there.
+     */
+    for (const char *pos = *needle; *pos && (size_t)(pos - *needle) < index->maxlen[form];) {
+        if (form == READARG_FORM_LONG && *pos == '=')
+            break;
+
+        hash = readarg_hash_step(hash, *pos++);
+
+        struct readarg_index_slot *slot = readarg_index_probe(index, form, *needle, pos - *needle, hash);
+        if (slot->name)
+            match = slot->opt, adv = pos;
+    }
+
+    if (adv)
+        *needle = adv;
+
+    return match;
+}
+
+static enum readarg_error readarg_index_add_opt(struct readarg_index *index, struct readarg_opt *opt) {
+    for (size_t form = 0; form < sizeof opt->names / sizeof *opt->names; form++) {
+        for (size_t i = 0; opt->names[form] && opt->names[form][i]; i++) {
+            const char *name = opt->names[form][i];
+            size_t len = strlen(name);
+            size_t hash = readarg_hash(form, name, len);
+
+            struct readarg_index_slot *slot = readarg_index_probe(index, form, name, len, hash);
+
+            if (slot->name) {
+                if (slot->opt == opt)
+                    /* The option lists the same name twice. */
+                    continue;
+
+                readarg_index_drop_opt(index, opt);
+                return READARG_EDUPNAME;
+            }
+
+            /* Keep the load factor at or below 3/4 so that probe sequences stay short and always end. */
+            if (index->len + 1 > index->cap / 4 * 3) {
+                readarg_index_drop_opt(index, opt);
+                return READARG_ENOSPACE;
+            }
+
+            *slot = (struct readarg_index_slot){
+                .name = name,
+                .hash = hash,
+                .form = form,
+                .opt = opt,
+            };
+            ++index->len;
+
+            if (len > index->maxlen[form])
+                index->maxlen[form] = len;
+        }
+    }
+
+    return READARG_ESUCCESS;
+}
+
+static void readarg_index_drop_opt(struct readarg_index *index, struct readarg_opt *opt) {
+    /* Names are dropped in reverse order of insertion, which keeps the probe sequences of the remaining names intact. Only the slots owned by opt are cleared, so this also works for partially added options. */
+    for (size_t form = sizeof opt->names / sizeof *opt->names; form--;) {
+        size_t n = 0;
+        while (opt->names[form] && opt->names[form][n])
+            ++n;
+
+        while (n--) {
+            const char *name = opt->names[form][n];
+            size_t len = strlen(name);
+
+            /* A repeated name belongs to the slot of its first occurrence. */
+            size_t first = 0;
+            while (strcmp(opt->names[form][first], name))
+                ++first;
+            if (first != n)
+                continue;
+
+            struct readarg_index_slot *slot = readarg_index_probe(index, form, name, len, readarg_hash(form, name, len));
+            if (slot->name && slot->opt == opt) {
+                *slot = (struct readarg_index_slot){0};
+                --index->len;
+            }
+        }
+    }
+}
+
+static struct readarg_index_slot *readarg_index_probe(struct readarg_index *index, enum readarg_form form, const char *name, size_t len, size_t hash) {
+    size_t mask = index->cap - 1;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        struct readarg_index_slot *slot = &index->slots[i];
+
+        if (!slot->name)
+            return slot;
+
+        if (slot->hash == hash && slot->form == form && !strncmp(slot->name, name, len) && !slot->name[len])
+            return slot;
+    }
+}
+
+static size_t readarg_checkpoint_nvals(const struct readarg_parser_state *state, struct readarg_opt *opt, struct readarg_view_strings val) {
+    /* Options without an argument only count occurrences, and the occurrence of a pending option has no value yet. */
+    if (!opt->arg.name || !val.strings)
+        return 0;
+
+    return val.len - (state->pending && state->curr.opt == opt);
+}
+
+static void readarg_map_put(struct readarg_parser *rp, struct readarg_map *map, const char *string) {
+    /* The string is split without being written to, so the key is only delimited by its length. */
+    size_t keylen = strcspn(string, "=");
+    size_t hash = readarg_map_hash(string, keylen);
+    const char *sep = string + keylen;
+
+    const char *val = *sep ? sep + 1 : NULL;
+    struct readarg_map_entry *entry = readarg_map_probe(map, string, sep - string, hash);
+
+    if (entry->key) {
+        if (!map->first)
+            entry->val = val;
+        return;
+    }
+
+    /* Keep the load factor at or below 3/4 so that probe sequences stay short and always end. */
+    if (map->len + 1 > map->cap / 4 * 3) {
+        rp->error = READARG_ENOSPACE;
+        return;
+    }
+
+    *entry = (struct readarg_map_entry){
+        .key = string,
+        .keylen = sep - string,
+        .hash = hash,
+        .val = val,
+    };
+    ++map->len;
+}
+
+static struct readarg_map_entry *readarg_map_probe(const struct readarg_map *map, const char *key, size_t keylen, size_t hash) {
+    size_t mask = map->cap - 1;
+
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        struct readarg_map_entry *entry = &map->entries[i];
+
+        if (!entry->key)
+            return entry;
+
+        if (entry->hash == hash && entry->keylen == keylen && !memcmp(entry->key, key, keylen))
+            return entry;
+    }
+}
+
+static size_t readarg_map_hash(const char *key, size_t keylen) {
+    size_t hash = READARG_HASH_BASIS;
+    for (size_t i = 0; i < keylen; i++)
+        hash = readarg_hash_step(hash, key[i]);
+    return hash;
+}
+
+static size_t readarg_hash(enum readarg_form form, const char *name, size_t len) {
+    /* The form is hashed as well, since short and long names live in the same table. */
+    size_t hash = readarg_hash_step(READARG_HASH_BASIS, form);
+    for (size_t i = 0; i < len; i++)
+        hash = readarg_hash_step(hash, name[i]);
+    return hash;
+}
+
+static size_t readarg_hash_step(size_t hash, unsigned char c) {
+    /* FNV-1a */
+    return (hash ^ c) * 16777619u;
+}
+
+static int readarg_is_sep(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static const char *readarg_scan_next(struct readarg_scanner *rs) {
+    const char *end = rs->buf + rs->len;
+    const char *string = rs->state.pos;
+
+    if (string >= end)
+        return NULL;
+
+    const char *term = memchr(string, '\0', end - string);
+    rs->state.pos = term ? term + 1 : end;
+
+    return string;
 }
 
 static void readarg_update_opt(struct readarg_parser *rp, const char *attach, struct readarg_opt *opt) {
     if (opt->arg.name) {
         if (attach) {
             /* --opt=value, --opt=, -ovalue */
-            struct readarg_arg *curr = &rp->state.curr.opt->arg;
             readarg_occ_opt(rp, opt);
-            readarg_add_val(rp, curr, attach, 0);
+            readarg_add_val(rp, opt, attach, 0);
         } else {
             /* --opt value, -o value */
             rp->state.pending = 1;
@@ -517,18 +1144,27 @@ static void readarg_update_oper(struct readarg_parser *rp, struct readarg_view_s
         ++rp->state.curr.ioper.len;
         readarg_permute_val(rp, &rp->state.curr.ioper, val.strings[0], 1);
     } else {
+        /* The operands are appended to the intermediate operands, which always end at eoval. */
+        if (!rp->state.curr.ioper.strings)
+            rp->state.curr.ioper.strings = rp->state.curr.eoval;
         readarg_permute_rest(rp->state.curr.eoval, val);
         rp->state.curr.ioper.len += val.len;
+        rp->state.curr.eoval += val.len;
     }
 }
 
-static void readarg_add_val(struct readarg_parser *rp, struct readarg_arg *arg, const char *string, int end) {
+static void readarg_add_val(struct readarg_parser *rp, struct readarg_opt *opt, const char *string, int end) {
     rp->state.pending = 0;
 
-    if (!readarg_validate_arg(arg))
+    if (!readarg_validate_arg(&opt->arg)) {
         rp->error = READARG_ERANGEOPT;
-    else
-        readarg_permute_val(rp, &arg->val, string, end);
+        return;
+    }
+
+    readarg_permute_val(rp, &opt->arg.val, string, end);
+
+    if (opt->map)
+        readarg_map_put(rp, opt->map, string);
 }
 
 static const char *readarg_skip_incl(const char *outer, const char *inner) {
@@ -574,6 +1210,420 @@ static void readarg_permute_rest(const char **target, struct readarg_view_string
     memmove(target, start.strings, start.len * sizeof *start.strings);
 }
 
+#ifdef READARG_GETOPT
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The number of options which can be translated. The index has twice as many slots, so this has to be a power of two. */
+#ifndef READARG_GETOPT_MAX
+#define READARG_GETOPT_MAX 128
+#endif
+
+/* The size of the buffer which holds copies of the long option names. */
+#ifndef READARG_GETOPT_NAMES
+#define READARG_GETOPT_NAMES (READARG_GETOPT_MAX * 32)
+#endif
+
+/* Fails to compile if READARG_GETOPT_MAX is not a power of two. */
+typedef char readarg_getopt_max_check[READARG_GETOPT_MAX >= 2 && !(READARG_GETOPT_MAX & (READARG_GETOPT_MAX - 1)) ? 1 : -1];
+
+/* The translated form of a single optstring character or longopts entry. */
+struct readarg_getopt_opt {
+    char *names[2];
+    char shortname[2];
+    int has_arg;
+    int *flag;
+    int val;
+    /* Offset into longopts, or -1 for options from optstring. */
+    int longindex;
+};
+
+static struct {
+    /* The spec is cached for the optstring and longopts it was translated from, which are told apart by their address and a hash of their contents. */
+    const char *optstring;
+    const struct option *longopts;
+    size_t hash;
+    /* Tables which do not fit are passed on to getopt_long. */
+    int fallback;
+    size_t nopts;
+    struct readarg_opt opts[READARG_GETOPT_MAX];
+    struct readarg_getopt_opt extra[READARG_GETOPT_MAX];
+    struct readarg_index_slot slots[READARG_GETOPT_MAX * 2];
+    struct readarg_index index;
+    /* The long names are copied, since the caller's table may be gone by the next call. */
+    char names[READARG_GETOPT_NAMES];
+    size_t nnames;
+    /* '+' or '-' if optstring starts with either. */
+    char prefix;
+    /* '+' stops at the first operand, '-' returns operands as options with the value 1. */
+    char order;
+    int colon;
+    /* "W;" in optstring makes -W foo stand for --foo. */
+    int wlong;
+    /* The value optind was left at, which tells whether the caller has reset it since, or -1 once parsing has ended. */
+    int optind;
+    /* Offset of the first operand that has been skipped over and still has to be moved behind the options. */
+    int first;
+    const char *grppos;
+} readarg_getopt_state;
+
+static size_t readarg_getopt_hash(const char *optstring, const struct option *longopts);
+static size_t readarg_getopt_hash_bytes(size_t hash, const void *data, size_t len);
+static void readarg_getopt_translate(const char *optstring, const struct option *longopts, size_t hash);
+static int readarg_getopt_add(int has_arg, int *flag, int val, int longindex, const char *shortname, const char *longname);
+static int readarg_getopt_long_opt(int argc, char *const argv[], int *longindex, const char *prefix, const char *name, int consumed);
+static int readarg_getopt_short_opt(int argc, char *const argv[], int *longindex);
+static int readarg_getopt_finish(char *const argv[], int pos, int consumed);
+
+int readarg_getopt_long(int argc, char *const argv[], const char *optstring, const struct option *longopts, int *longindex) {
+    int restart = optind == 0 || optind != readarg_getopt_state.optind;
+
+    if (restart || readarg_getopt_state.optstring != optstring || readarg_getopt_state.longopts != longopts) {
+        /* A different table may have taken the place of the last one, such as a local array in another function. */
+        size_t hash = readarg_getopt_hash(optstring, longopts);
+        if (readarg_getopt_state.optstring != optstring || readarg_getopt_state.longopts != longopts || readarg_getopt_state.hash != hash)
+            readarg_getopt_translate(optstring, longopts, hash);
+    }
+
+    if (readarg_getopt_state.fallback) {
+        /* getopt_long only starts over once optind is 0. */
+        if (restart && optind == 1)
+            optind = 0;
+
+        int rv = getopt_long(argc, argv, optstring, longopts, longindex);
+        readarg_getopt_state.optind = rv == -1 ? -1 : optind;
+        return rv;
+    }
+
+    if (restart) {
+        /* optind has been reset, so parsing starts over. */
+        if (optind == 0)
+            optind = 1;
+        readarg_getopt_state.first = optind;
+        readarg_getopt_state.grppos = NULL;
+        /* Like in glibc, POSIXLY_CORRECT stops at the first operand unless optstring asks for an order itself. */
+        readarg_getopt_state.order = readarg_getopt_state.prefix ? readarg_getopt_state.prefix : getenv("POSIXLY_CORRECT") ? '+' : 0;
+    }
+
+    optarg = NULL;
+
+    int rv;
+    if (readarg_getopt_state.grppos) {
+        rv = readarg_getopt_short_opt(argc, argv, longindex);
+    } else {
+        int pos = optind;
+        while (pos < argc && (argv[pos][0] != '-' || argv[pos][1] == '\0')) {
+            if (readarg_getopt_state.order == '+') {
+                optind = pos;
+                readarg_getopt_state.optind = -1;
+                return -1;
+            }
+
+            if (readarg_getopt_state.order == '-') {
+                optarg = argv[pos];
+                readarg_getopt_state.optind = optind = readarg_getopt_finish(argv, pos, 1);
+                return 1;
+            }
+
+            /* Skip the operand for now, it will be moved behind the options. */
+            ++pos;
+        }
+
+        if (pos >= argc) {
+            optind = readarg_getopt_state.first;
+            readarg_getopt_state.optind = -1;
+            return -1;
+        }
+
+        optind = pos;
+
+        if (argv[pos][1] == '-' && argv[pos][2] == '\0') {
+            /* "--" denotes the end of options. */
+            readarg_getopt_finish(argv, pos, 1);
+            optind = readarg_getopt_state.first;
+            readarg_getopt_state.optind = -1;
+            return -1;
+        }
+
+        if (argv[pos][1] == '-') {
+            rv = readarg_getopt_long_opt(argc, argv, longindex, "--", argv[pos] + 2, 1);
+        } else {
+            readarg_getopt_state.grppos = argv[pos] + 1;
+            rv = readarg_getopt_short_opt(argc, argv, longindex);
+        }
+    }
+
+    readarg_getopt_state.optind = optind;
+    return rv;
+}
+
+static size_t readarg_getopt_hash(const char *optstring, const struct option *longopts) {
+    size_t hash = readarg_getopt_hash_bytes(READARG_HASH_BASIS, optstring, strlen(optstring) + 1);
+
+    for (int i = 0; longopts && longopts[i].name; i++) {
+        hash = readarg_getopt_hash_bytes(hash, longopts[i].name, strlen(longopts[i].name) + 1);
+        hash = readarg_getopt_hash_bytes(hash, &longopts[i].has_arg, sizeof longopts[i].has_arg);
+        hash = readarg_getopt_hash_bytes(hash, &longopts[i].flag, sizeof longopts[i].flag);
+        hash = readarg_getopt_hash_bytes(hash, &longopts[i].val, sizeof longopts[i].val);
+    }
+
+    return hash;
+}
+
+static size_t readarg_getopt_hash_bytes(size_t hash, const void *data, size_t len) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < len; i++)
+        hash = readarg_hash_step(hash, bytes[i]);
+    return hash;
+}
+
+static void readarg_getopt_translate(const char *optstring, const struct option *longopts, size_t hash) {
+    readarg_getopt_state.optstring = optstring;
+    readarg_getopt_state.longopts = longopts;
+    readarg_getopt_state.hash = hash;
+    readarg_getopt_state.fallback = 0;
+    readarg_getopt_state.nopts = 0;
+    readarg_getopt_state.nnames = 0;
+    readarg_getopt_state.prefix = 0;
+    readarg_getopt_state.colon = 0;
+    readarg_getopt_state.wlong = 0;
+    readarg_index_init(&readarg_getopt_state.index, readarg_getopt_state.slots, sizeof readarg_getopt_state.slots / sizeof *readarg_getopt_state.slots);
+
+    const char *pos = optstring;
+    if (*pos == '+' || *pos == '-')
+        readarg_getopt_state.prefix = *pos++;
+    if (*pos == ':')
+        readarg_getopt_state.colon = 1, ++pos;
+
+    for (; *pos; ++pos) {
+        if (*pos == ':')
+            continue;
+
+        if (pos[0] == 'W' && pos[1] == ';' && longopts) {
+            /* Like in glibc, the ';' itself is still an option character. */
+            readarg_getopt_state.wlong = 1;
+            continue;
+        }
+
+        int has_arg = pos[1] != ':' ? no_argument : pos[2] != ':' ? required_argument : optional_argument;
+        if (!readarg_getopt_add(has_arg, NULL, (unsigned char)*pos, -1, pos, NULL)) {
+            readarg_getopt_state.fallback = 1;
+            return;
+        }
+    }
+
+    for (int i = 0; longopts && longopts[i].name; i++) {
+        if (!readarg_getopt_add(longopts[i].has_arg, longopts[i].flag, longopts[i].val, i, NULL, longopts[i].name)) {
+            readarg_getopt_state.fallback = 1;
+            return;
+        }
+    }
+}
+
+static int readarg_getopt_add(int has_arg, int *flag, int val, int longindex, const char *shortname, const char *longname) {
+    size_t i = readarg_getopt_state.nopts;
+    if (i >= READARG_GETOPT_MAX)
+        return 0;
+
+    struct readarg_getopt_opt *extra = &readarg_getopt_state.extra[i];
+    *extra = (struct readarg_getopt_opt){
+        .has_arg = has_arg,
+        .flag = flag,
+        .val = val,
+        .longindex = longindex,
+    };
+
+    struct readarg_opt *opt = &readarg_getopt_state.opts[i];
+    *opt = (struct readarg_opt){0};
+
+    if (shortname) {
+        extra->shortname[0] = *shortname;
+        extra->names[0] = extra->shortname;
+        opt->names[READARG_FORM_SHORT] = extra->names;
+    } else {
+        size_t len = strlen(longname) + 1;
+        if (len > sizeof readarg_getopt_state.names - readarg_getopt_state.nnames)
+            return 0;
+
+        extra->names[0] = memcpy(readarg_getopt_state.names + readarg_getopt_state.nnames, longname, len);
+        readarg_getopt_state.nnames += len;
+        opt->names[READARG_FORM_LONG] = extra->names;
+    }
+
+    ++readarg_getopt_state.nopts;
+
+    /* getopt_long uses the first of several entries with the same name, so later ones are just left out of the index. */
+    readarg_index_add(&readarg_getopt_state.index, opt, 1);
+
+    return 1;
+}
+
+static int readarg_getopt_long_opt(int argc, char *const argv[], int *longindex, const char *prefix, const char *name, int consumed) {
+    const char *pos = name;
+
+    struct readarg_opt *match = readarg_match_in(readarg_getopt_state.opts, readarg_getopt_state.nopts, &readarg_getopt_state.index, READARG_FORM_LONG, &pos);
+
+    if (!match || (*pos && *pos != '=')) {
+        /* Fall back to a linear search for an unambiguous abbreviation. */
+        size_t len = strcspn(name, "=");
+        match = NULL;
+
+        for (size_t i = 0; i < readarg_getopt_state.nopts; i++) {
+            char **names = readarg_getopt_state.opts[i].names[READARG_FORM_LONG];
+            if (!len || !names || strncmp(names[0], name, len))
+                continue;
+
+            if (match) {
+                struct readarg_getopt_opt *prev = &readarg_getopt_state.extra[match - readarg_getopt_state.opts];
+                struct readarg_getopt_opt *curr = &readarg_getopt_state.extra[i];
+                if (prev->has_arg == curr->has_arg && prev->flag == curr->flag && prev->val == curr->val)
+                    /* Like in glibc, candidates which behave the same are not ambiguous and the first one is used. */
+                    continue;
+
+                if (opterr && !readarg_getopt_state.colon)
+                    fprintf(stderr, "%s: option '%s%.*s' is ambiguous\n", argv[0], prefix, (int)len, name);
+                optopt = 0;
+                optind = readarg_getopt_finish(argv, optind, consumed);
+                return '?';
+            }
+
+            match = &readarg_getopt_state.opts[i];
+        }
+
+        if (!match) {
+            if (opterr && !readarg_getopt_state.colon)
+                fprintf(stderr, "%s: unrecognized option '%s%s'\n", argv[0], prefix, name);
+            optopt = 0;
+            optind = readarg_getopt_finish(argv, optind, consumed);
+            return '?';
+        }
+
+        pos = name + len;
+    }
+
+    struct readarg_getopt_opt *extra = &readarg_getopt_state.extra[match - readarg_getopt_state.opts];
+
+    if (*pos == '=') {
+        if (extra->has_arg == no_argument) {
+            if (opterr && !readarg_getopt_state.colon)
+                fprintf(stderr, "%s: option '%s%s' doesn't allow an argument\n", argv[0], prefix, match->names[READARG_FORM_LONG][0]);
+            optopt = extra->val;
+            optind = readarg_getopt_finish(argv, optind, consumed);
+            return '?';
+        }
+
+        optarg = (char *)pos + 1;
+    } else if (extra->has_arg == required_argument) {
+        if (optind + consumed >= argc) {
+            if (opterr && !readarg_getopt_state.colon)
+                fprintf(stderr, "%s: option '%s%s' requires an argument\n", argv[0], prefix, match->names[READARG_FORM_LONG][0]);
+            optopt = extra->val;
+            optind = readarg_getopt_finish(argv, optind, consumed);
+            return readarg_getopt_state.colon ? ':' : '?';
+        }
+
+        optarg = argv[optind + consumed];
+        ++consumed;
+    }
+
+    optind = readarg_getopt_finish(argv, optind, consumed);
+
+    if (longindex)
+        *longindex = extra->longindex;
+
+    if (extra->flag) {
+        *extra->flag = extra->val;
+        return 0;
+    }
+
+    return extra->val;
+}
+
+static int readarg_getopt_short_opt(int argc, char *const argv[], int *longindex) {
+    const char *pos = readarg_getopt_state.grppos;
+    unsigned char c = *pos;
+
+    if (c == 'W' && readarg_getopt_state.wlong) {
+        /* -Wfoo and -W foo stand for --foo, and take the rest of the group with them. */
+        readarg_getopt_state.grppos = NULL;
+        if (pos[1])
+            return readarg_getopt_long_opt(argc, argv, longindex, "-W ", pos + 1, 1);
+        if (optind + 1 < argc)
+            return readarg_getopt_long_opt(argc, argv, longindex, "-W ", argv[optind + 1], 2);
+
+        if (opterr && !readarg_getopt_state.colon)
+            fprintf(stderr, "%s: option requires an argument -- '%c'\n", argv[0], c);
+        optopt = c;
+        optind = readarg_getopt_finish(argv, optind, 1);
+        return readarg_getopt_state.colon ? ':' : '?';
+    }
+
+    struct readarg_opt *match = readarg_match_in(readarg_getopt_state.opts, readarg_getopt_state.nopts, &readarg_getopt_state.index, READARG_FORM_SHORT, &pos);
+    if (!match) {
+        /* Skip the unknown character, but not the rest of the group. */
+        ++pos;
+    }
+
+    int consumed = 1;
+    int rv;
+
+    if (!match) {
+        if (opterr && !readarg_getopt_state.colon)
+            fprintf(stderr, "%s: invalid option -- '%c'\n", argv[0], c);
+        optopt = c;
+        rv = '?';
+    } else {
+        struct readarg_getopt_opt *extra = &readarg_getopt_state.extra[match - readarg_getopt_state.opts];
+        rv = extra->val;
+
+        if (extra->has_arg != no_argument && *pos) {
+            /* -ovalue */
+            optarg = (char *)pos;
+            pos += strlen(pos);
+        } else if (extra->has_arg == required_argument) {
+            if (optind + 1 < argc) {
+                optarg = argv[optind + 1];
+                consumed = 2;
+            } else {
+                if (opterr && !readarg_getopt_state.colon)
+                    fprintf(stderr, "%s: option requires an argument -- '%c'\n", argv[0], c);
+                optopt = c;
+                rv = readarg_getopt_state.colon ? ':' : '?';
+            }
+        }
+    }
+
+    if (*pos) {
+        readarg_getopt_state.grppos = pos;
+    } else {
+        readarg_getopt_state.grppos = NULL;
+        optind = readarg_getopt_finish(argv, optind, consumed);
+    }
+
+    return rv;
+}
+
+static int readarg_getopt_finish(char *const argv[], int pos, int consumed) {
+    /* Move the consumed elements in front of the skipped operands, just like GNU getopt_long permutes argv. */
+    int first = readarg_getopt_state.first;
+    char **args = (char **)argv;
+    char *tmp[3];
+
+    assert(consumed >= 1 && consumed <= 3);
+
+    if (first < pos) {
+        memcpy(tmp, args + pos, consumed * sizeof *args);
+        memmove(args + first + consumed, args + first, (pos - first) * sizeof *args);
+        memcpy(args + first, tmp, consumed * sizeof *args);
+    }
+
+    readarg_getopt_state.first = first + consumed;
+    return pos + consumed;
+}
+
+#endif
+
 #ifdef READARG_DEBUG
 #pragma pop_macro("NDEBUG")
 #endif
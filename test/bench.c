@@ -0,0 +1,102 @@
+#define READARG_IMPLEMENTATION
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../readarg.h"
+
+#define NPROCS  4096
+#define NROUNDS 64
+
+enum opt {
+    OPT_CONFIG,
+    OPT_PORT,
+};
+
+/* Append a null-terminated string to the dump and return the new length. */
+static size_t put(char *dump, size_t len, const char *s);
+
+int main(void) {
+    struct readarg_opt opts[] = {
+        [OPT_CONFIG] = {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("c"),
+                [READARG_FORM_LONG] = READARG_STRINGS("config"),
+            },
+            .arg.name = "file",
+        },
+        [OPT_PORT] = {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("p"),
+                [READARG_FORM_LONG] = READARG_STRINGS("port"),
+            },
+            .arg.name = "port",
+        },
+    };
+
+    /* A synthetic /proc snapshot: every process gets its own cmdline blob inside one large dump. */
+    static char dump[NPROCS * 256];
+    static size_t off[NPROCS + 1];
+    size_t len = 0;
+
+    for (size_t i = 0; i < NPROCS; i++) {
+        char buf[32];
+        off[i] = len;
+
+        len = put(dump, len, "/usr/bin/daemon");
+        len = put(dump, len, "-vv");
+        len = put(dump, len, "--log-level=debug");
+        len = put(dump, len, "--workers");
+        len = put(dump, len, "8");
+        if (i % 2) {
+            sprintf(buf, "--port=%zu", 1024 + i);
+            len = put(dump, len, buf);
+        }
+        len = put(dump, len, "--config");
+        sprintf(buf, "/etc/daemon/%zu.conf", i);
+        len = put(dump, len, buf);
+        len = put(dump, len, "--foreground");
+        len = put(dump, len, "input.txt");
+    }
+    off[NPROCS] = len;
+
+    size_t found = 0;
+    clock_t start = clock();
+
+    for (size_t round = 0; round < NROUNDS; round++) {
+        for (size_t i = 0; i < NPROCS; i++) {
+            /* Skip the program name. */
+            const char *buf = dump + off[i] + strlen(dump + off[i]) + 1;
+
+            struct readarg_scanner rs;
+            readarg_scanner_init(&rs, opts, sizeof opts / sizeof *opts, buf, dump + off[i + 1] - buf);
+
+            int config = 0, port = 0;
+            while (!(config && port) && readarg_scan(&rs)) {
+                config |= rs.opt == &opts[OPT_CONFIG];
+                port |= rs.opt == &opts[OPT_PORT];
+            }
+            if (rs.error != READARG_ESUCCESS) {
+                fprintf(stderr, "Error: %d\n", rs.error);
+                return 1;
+            }
+
+            found += config + port;
+        }
+    }
+
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%zu options found in %d processes (%zu bytes)\n", found / NROUNDS, NPROCS, len);
+    printf("%.1f ns per process\n", secs * 1e9 / ((double)NPROCS * NROUNDS));
+
+    return 0;
+}
+
+static size_t put(char *dump, size_t len, const char *s) {
+    size_t n = strlen(s) + 1;
+    memcpy(dump + len, s, n);
+    return len + n;
+}
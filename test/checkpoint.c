@@ -0,0 +1,197 @@
+#define READARG_IMPLEMENTATION
+#define READARG_DEBUG
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../readarg.h"
+
+#define NITERS   200000
+#define MAXARGS  12
+#define NOPTS    6
+#define NENTRIES 32
+
+/* The tokens from which argument vectors are put together. */
+static const char *pool[] = {
+    "-e", "a", "--expr=b", "-xq", "-c", "-vv", "-v", "-s", "--sort", "-D", "K=1", "-DK=2", "-DJ", "o1", "o2", "--", "-", "-ve", "--uri", "u", "-iv",
+};
+
+static struct readarg_map_entry entries[NENTRIES];
+static struct readarg_map defines;
+
+static struct readarg_opt spec[NOPTS] = {
+    {
+        .names = {
+            [READARG_FORM_SHORT] = READARG_STRINGS("e", "x"),
+            [READARG_FORM_LONG] = READARG_STRINGS("expr"),
+        },
+        .arg = {
+            .name = "expression",
+            .bounds.inf = 1,
+        },
+    },
+    {
+        .names = {
+            [READARG_FORM_SHORT] = READARG_STRINGS("c"),
+        },
+        .arg = {
+            .name = "file",
+            .bounds.inf = 1,
+        },
+    },
+    {
+        .names = {
+            [READARG_FORM_SHORT] = READARG_STRINGS("v"),
+        },
+        .arg.bounds.inf = 1,
+    },
+    {
+        .names = {
+            [READARG_FORM_SHORT] = READARG_STRINGS("s"),
+            [READARG_FORM_LONG] = READARG_STRINGS("sort"),
+        },
+        .arg.bounds.inf = 1,
+    },
+    {
+        .names = {
+            [READARG_FORM_SHORT] = READARG_STRINGS("D"),
+        },
+        .arg = {
+            .name = "name=value",
+            .bounds.inf = 1,
+        },
+        .map = &defines,
+    },
+    {
+        .names = {
+            [READARG_FORM_SHORT] = READARG_STRINGS("i"),
+            [READARG_FORM_LONG] = READARG_STRINGS("uri"),
+        },
+        .arg = {
+            .name = "uri",
+            .bounds.inf = 1,
+        },
+    },
+};
+
+static struct readarg_opt opts[NOPTS];
+
+/* Reset the options and the map before a parse. */
+static void reset(void);
+/* Write everything the parser has collected to out. */
+static void dump(struct readarg_parser *rp, char *out);
+static unsigned long next_random(void);
+
+int main(void) {
+    for (size_t iter = 0; iter < NITERS; iter++) {
+        /* Parse old, then edit it to new by keeping the first nkeep elements and appending or replacing the rest. */
+        const char *old[MAXARGS], *new[2 * MAXARGS], *args[2 * MAXARGS];
+        size_t nold = next_random() % MAXARGS;
+        size_t nkeep = next_random() % (nold + 1);
+        size_t nnew = nkeep + next_random() % MAXARGS;
+
+        for (size_t i = 0; i < nold; i++)
+            old[i] = pool[next_random() % (sizeof pool / sizeof *pool)];
+        for (size_t i = 0; i < nnew; i++)
+            new[i] = i < nkeep ? old[i] : pool[next_random() % (sizeof pool / sizeof *pool)];
+
+        static char want[4096], got[4096];
+        struct readarg_parser rp;
+
+        reset();
+        memcpy(args, new, nnew * sizeof *args);
+        readarg_parser_init(&rp, opts, NOPTS, NULL, 0, (struct readarg_view_strings){.strings = args, .len = nnew});
+        while (readarg_parse(&rp));
+        dump(&rp, want);
+
+        reset();
+        memcpy(args, old, nold * sizeof *args);
+        readarg_parser_init(&rp, opts, NOPTS, NULL, 0, (struct readarg_view_strings){.strings = args, .len = nold});
+
+        static struct readarg_view_strings vals[MAXARGS + 2][NOPTS];
+        struct readarg_checkpoint cps[MAXARGS + 2];
+        size_t ncps = 0;
+        int more;
+        do {
+            cps[ncps] = (struct readarg_checkpoint){.vals = vals[ncps], .cap = NOPTS};
+            if (readarg_checkpoint_save(&rp, &cps[ncps]))
+                ++ncps;
+            more = readarg_parse(&rp);
+        } while (more);
+        cps[ncps] = (struct readarg_checkpoint){.vals = vals[ncps], .cap = NOPTS};
+        if (readarg_checkpoint_save(&rp, &cps[ncps]))
+            ++ncps;
+
+        /* Resume from the last checkpoint which does not depend on any replaced element. */
+        struct readarg_checkpoint *cp = NULL;
+        for (size_t i = 0; i < ncps; i++)
+            if ((size_t)(cps[i].state.curr.arg - args) <= nkeep)
+                cp = &cps[i];
+
+        /* There is always a checkpoint at the start. */
+        if (!cp) {
+            fprintf(stderr, "No checkpoint for iteration %zu\n", iter);
+            return 1;
+        }
+
+        readarg_checkpoint_restore(&rp, cp, nnew);
+        for (size_t i = cp->state.curr.arg - args; i < nnew; i++)
+            args[i] = new[i];
+        while (readarg_parse(&rp));
+        dump(&rp, got);
+
+        if (strcmp(want, got)) {
+            fprintf(stderr, "Mismatch after keeping %zu elements of:\n ", nkeep);
+            for (size_t i = 0; i < nold; i++)
+                fprintf(stderr, " %s", old[i]);
+            fprintf(stderr, "\nand editing it to:\n ");
+            for (size_t i = 0; i < nnew; i++)
+                fprintf(stderr, " %s", new[i]);
+            fprintf(stderr, "\n  full:        %s\n  incremental: %s\n", want, got);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void reset(void) {
+    readarg_map_init(&defines, entries, NENTRIES, 0);
+    memcpy(opts, spec, sizeof spec);
+}
+
+static void dump(struct readarg_parser *rp, char *out) {
+    out += sprintf(out, "error=%d pending=%d", rp->error, rp->state.pending);
+    if (rp->error)
+        /* The values are incomplete after an error. */
+        return;
+
+    for (size_t i = 0; i < NOPTS; i++) {
+        struct readarg_view_strings val = opts[i].arg.val;
+        out += sprintf(out, " [%zu]", val.len);
+
+        size_t n = opts[i].arg.name && val.strings ? val.len : 0;
+        if (n && rp->state.pending && rp->state.curr.opt == &opts[i])
+            --n;
+        for (size_t j = 0; j < n; j++)
+            out += sprintf(out, " %s", val.strings[j]);
+    }
+
+    out += sprintf(out, " |");
+    for (size_t i = 0; i < rp->state.curr.ioper.len; i++)
+        out += sprintf(out, " %s", rp->state.curr.ioper.strings[i]);
+
+    out += sprintf(out, " |");
+    for (size_t i = 0; i < NENTRIES; i++)
+        if (entries[i].key)
+            out += sprintf(out, " %.*s=%s", (int)entries[i].keylen, entries[i].key, entries[i].val ? entries[i].val : "");
+}
+
+static unsigned long next_random(void) {
+    /* A fixed xorshift sequence keeps failures reproducible. */
+    static unsigned long state = 2463534242ul;
+    state ^= (state << 13) & 0xfffffffful;
+    state ^= state >> 17;
+    state ^= (state << 5) & 0xfffffffful;
+    return state;
+}
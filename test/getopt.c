@@ -0,0 +1,144 @@
+#define READARG_IMPLEMENTATION
+#define READARG_DEBUG
+#define READARG_GETOPT
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../readarg.h"
+
+#define MAXARGS 16
+
+struct test {
+    const char *optstring;
+    const char *args[MAXARGS];
+};
+
+static int flag;
+
+static const struct option longopts[] = {
+    {"verbose", no_argument, NULL, 'v'},
+    {"config", required_argument, NULL, 'c'},
+    {"color", optional_argument, NULL, 'C'},
+    {"flag", no_argument, &flag, 7},
+    {"output", required_argument, NULL, 'o'},
+    /* Abbreviations of these two are not ambiguous, since they behave the same. */
+    {"quiet", no_argument, NULL, 'q'},
+    {"quieter", no_argument, NULL, 'q'},
+    {0},
+};
+
+/* More options than the replacement translates, filled in by main. */
+static struct option big[READARG_GETOPT_MAX + 2];
+static char bignames[READARG_GETOPT_MAX + 1][8];
+
+static const struct test tests[] = {
+    {"vc:o::x", {"-v", "a", "-c", "x", "b", "--verbose", "--config=y", "--config", "z", "c", "d"}},
+    {"vc:o::x", {"a", "-vxcfoo", "b", "-oq", "-o", "r", "--", "-v", "e"}},
+    {"+vc:", {"a", "-v"}},
+    {"+vc:", {"-v", "-c", "x", "a", "-v"}},
+    {"-vc:", {"a", "-v", "b", "-c"}},
+    {"vc:", {"-vz", "--verb", "--co=1", "--col", "--color=red", "--flag", "--nope", "-c"}},
+    {":vc:", {"-c"}},
+    {":vc:", {"--config"}},
+    {":vc:", {"-z", "--verbose=1"}},
+    {"vc:", {"--verbose=1", "-x", "--config"}},
+    {"vc:", {"a", "b", "c"}},
+    {"vc:", {"a", "--", "-v", "b"}},
+    {"vc:", {"a", "-v", "--"}},
+    {"vc:", {"a", "-v", "-"}},
+    {"vc:", {"--c", "--=x", "--qui", "--quiet", "--quiete"}},
+    {"vc:", {0}},
+    {"vW;c:", {"-W", "verbose", "-Wconf=x", "-vW", "col", "-W", "output", "o", "-Wnope", "a", "-W"}},
+    {":vW;", {"-Wflag=1", "-W", "config", "-W;"}},
+};
+
+/* These are passed on to getopt_long, since big does not fit. */
+static const struct test bigtests[] = {
+    {"vc:", {"-v", "--o0", "--o12=x", "--o1", "--o128", "a"}},
+    {"vc:", {"a", "--o7", "x", "-c"}},
+};
+
+/* Run getopt_long or its replacement and write everything it reports to out. */
+static void run(int shim, const struct test *test, const struct option *lo, char *out);
+/* Parse --name with a table local to this function, which is at the same address on every call. */
+static int run_local(const char *name);
+
+int main(void) {
+    int failed = 0;
+
+    for (int i = 0; i <= READARG_GETOPT_MAX; i++) {
+        sprintf(bignames[i], "o%d", i);
+        big[i] = (struct option){bignames[i], i % 2 ? required_argument : no_argument, NULL, 256 + i};
+    }
+
+    for (size_t i = 0; i < sizeof tests / sizeof *tests; i++) {
+        static char want[4096], got[4096];
+        run(0, &tests[i], longopts, want);
+        run(1, &tests[i], longopts, got);
+
+        if (strcmp(want, got)) {
+            fprintf(stderr, "Mismatch for \"%s\":\n  getopt_long:         %s\n  readarg_getopt_long: %s\n", tests[i].optstring, want, got);
+            failed = 1;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof bigtests / sizeof *bigtests; i++) {
+        static char want[4096], got[4096];
+        run(0, &bigtests[i], big, want);
+        run(1, &bigtests[i], big, got);
+
+        if (strcmp(want, got)) {
+            fprintf(stderr, "Mismatch for \"%s\" with too many options:\n  getopt_long:         %s\n  readarg_getopt_long: %s\n", bigtests[i].optstring, want, got);
+            failed = 1;
+        }
+    }
+
+    /* The replacement must not mistake the second table for the first one. */
+    if (run_local("alpha") != 'a' || run_local("bravo") != 'a') {
+        fprintf(stderr, "Mismatch for a table which replaced another one at the same address\n");
+        failed = 1;
+    }
+
+    return failed;
+}
+
+static void run(int shim, const struct test *test, const struct option *lo, char *out) {
+    char *argv[MAXARGS + 2] = {"getopt"};
+    int argc = 1;
+    for (; test->args[argc - 1]; argc++)
+        argv[argc] = (char *)test->args[argc - 1];
+
+    optind = 0;
+    opterr = 0;
+
+    for (;;) {
+        int longindex = -1;
+        int c = shim ? readarg_getopt_long(argc, argv, test->optstring, lo, &longindex) : getopt_long(argc, argv, test->optstring, lo, &longindex);
+
+        /* optopt is only meaningful after an error. */
+        out += sprintf(out, "%d:%s:%d:%d:%d:%d ", c, optarg ? optarg : "-", optind, longindex, c == '?' || c == ':' ? optopt : 0, flag);
+        flag = 0;
+
+        if (c == -1)
+            break;
+    }
+
+    out += sprintf(out, "|");
+    for (int i = 1; i < argc; i++)
+        out += sprintf(out, " %s", argv[i]);
+}
+
+static int run_local(const char *name) {
+    struct option lo[] = {
+        {name, no_argument, NULL, 'a'},
+        {0},
+    };
+
+    char arg[16] = "--";
+    char *argv[] = {"getopt", strcat(arg, name), NULL};
+
+    optind = 1;
+    opterr = 0;
+    return readarg_getopt_long(2, argv, "", lo, NULL);
+}
@@ -27,6 +27,10 @@ cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null
 	s \
 	t \
 	--sort \
+	-D CC=cc \
+	--define=CFLAGS=-O2 \
+	-DCC=gcc \
+	-DNDEBUG \
 	u \
 	v \
 	w \
@@ -34,3 +38,8 @@ cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &> /dev/null
 	x \
 	y \
 	z
+
+
+./getopt || exit
+POSIXLY_CORRECT=1 ./getopt || exit
+./checkpoint || exit
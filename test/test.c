@@ -2,6 +2,7 @@
 #define READARG_DEBUG
 
 #include <stdio.h>
+#include <string.h>
 
 #include "../readarg.h"
 
@@ -11,15 +12,43 @@ enum opt {
 };
 
 static int write_callback(void *ctx, const char *buf, size_t len);
+static int check_scan(int indexed);
+static int check_add_opts(int indexed);
+static int check_map(int first);
+static int check_tokenize(void);
 
 int main(int argc, char **argv) {
     const char *progname = argv[0] == NULL ? "test" : argv[0];
 
+    if (!check_scan(0) || !check_scan(1)) {
+        fprintf(stderr, "Error: scanning failed\n");
+        return 1;
+    }
+
+    if (!check_add_opts(0) || !check_add_opts(1)) {
+        fprintf(stderr, "Error: adding options at runtime failed\n");
+        return 1;
+    }
+
+    if (!check_map(0) || !check_map(1)) {
+        fprintf(stderr, "Error: key/value options failed\n");
+        return 1;
+    }
+
+    if (!check_tokenize()) {
+        fprintf(stderr, "Error: tokenizing failed\n");
+        return 1;
+    }
+
     struct readarg_helpgen_writer writer = {
         .write = write_callback,
         .ctx = NULL,
     };
 
+    struct readarg_map_entry entries[16];
+    struct readarg_map defines;
+    readarg_map_init(&defines, entries, sizeof entries / sizeof *entries, 0);
+
     struct readarg_opt opts[] = {
         [OPT_HELP] = {
             .names = {
@@ -99,6 +128,17 @@ int main(int argc, char **argv) {
             },
             .arg.bounds.inf = 1,
         },
+        {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("D"),
+                [READARG_FORM_LONG] = READARG_STRINGS("define"),
+            },
+            .arg = {
+                .name = "name=value",
+                .bounds.inf = 1,
+            },
+            .map = &defines,
+        },
     };
 
     struct readarg_arg opers[] = {
@@ -133,6 +173,15 @@ int main(int argc, char **argv) {
                             .len = argc - 1,
                         });
 
+    struct readarg_index_slot slots[64];
+    struct readarg_index index;
+    readarg_index_init(&index, slots, sizeof slots / sizeof *slots);
+    if (readarg_index_add(&index, opts, sizeof opts / sizeof *opts) != READARG_ESUCCESS) {
+        fprintf(stderr, "Error: indexing options failed\n");
+        return 1;
+    }
+    rp.index = &index;
+
     while (readarg_parse(&rp));
     if (rp.error != READARG_ESUCCESS) {
         fprintf(stderr, "Error: %d\n", rp.error);
@@ -198,6 +247,14 @@ int main(int argc, char **argv) {
         }
     }
 
+    printf("define:\n");
+    for (size_t i = 0; i < defines.cap; i++) {
+        if (defines.entries[i].key) {
+            const struct readarg_map_entry *curr = &defines.entries[i];
+            printf("%.*s { %s }\n", (int)curr->keylen, curr->key, curr->val ? curr->val : "");
+        }
+    }
+
     return 0;
 }
 
@@ -205,3 +262,232 @@ static int write_callback(void *ctx, const char *buf, size_t len) {
     (void)ctx;
     return fwrite(buf, 1, len, stderr) == len;
 }
+
+static int check_scan(int indexed) {
+    enum {
+        SCAN_VERBOSE,
+        SCAN_CONFIG,
+    };
+
+    struct readarg_opt opts[] = {
+        [SCAN_VERBOSE] = {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("v"),
+                [READARG_FORM_LONG] = READARG_STRINGS("verbose"),
+            },
+        },
+        [SCAN_CONFIG] = {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("c"),
+                [READARG_FORM_LONG] = READARG_STRINGS("config"),
+            },
+            .arg.name = "file",
+        },
+    };
+
+    struct readarg_index_slot slots[16];
+    struct readarg_index index;
+    readarg_index_init(&index, slots, sizeof slots / sizeof *slots);
+    if (readarg_index_add(&index, opts, sizeof opts / sizeof *opts) != READARG_ESUCCESS)
+        return 0;
+
+    /* Unknown options, operands and the flag with a value are skipped, and nothing after "--" is looked at. */
+    static const char buf[] = "-vq\0--config=a\0-c\0b\0-cfoo\0--verbose=1\0op\0--unknown\0-vc\0c\0--\0-c\0d";
+    struct {
+        int opt;
+        const char *val;
+    } expected[] = {
+        {SCAN_VERBOSE, NULL},
+        {SCAN_CONFIG, "a"},
+        {SCAN_CONFIG, "b"},
+        {SCAN_CONFIG, "foo"},
+        {SCAN_VERBOSE, NULL},
+        {SCAN_CONFIG, "c"},
+    };
+
+    struct readarg_scanner rs;
+    readarg_scanner_init(&rs, opts, sizeof opts / sizeof *opts, buf, sizeof buf - 1);
+    rs.index = indexed ? &index : NULL;
+    for (size_t i = 0; i < sizeof expected / sizeof *expected; i++) {
+        if (!readarg_scan(&rs) || rs.opt != &opts[expected[i].opt])
+            return 0;
+        if (expected[i].val ? !rs.val || strcmp(rs.val, expected[i].val) : rs.val != NULL)
+            return 0;
+    }
+    if (readarg_scan(&rs) || rs.error != READARG_ESUCCESS)
+        return 0;
+
+    /* The last string does not need to be null-terminated within len. */
+    static const char last[] = "-c\0file";
+    readarg_scanner_init(&rs, opts, sizeof opts / sizeof *opts, last, sizeof last - 1);
+    rs.index = indexed ? &index : NULL;
+    if (!readarg_scan(&rs) || rs.opt != &opts[SCAN_CONFIG] || strcmp(rs.val, "file") || readarg_scan(&rs) || rs.error != READARG_ESUCCESS)
+        return 0;
+
+    static const char trailing[] = "-v\0-c";
+    readarg_scanner_init(&rs, opts, sizeof opts / sizeof *opts, trailing, sizeof trailing - 1);
+    rs.index = indexed ? &index : NULL;
+    if (!readarg_scan(&rs) || rs.opt != &opts[SCAN_VERBOSE])
+        return 0;
+    return !readarg_scan(&rs) && rs.error == READARG_ENOVAL;
+}
+
+static int check_add_opts(int indexed) {
+    struct readarg_opt opts[4] = {
+        {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("a"),
+                [READARG_FORM_LONG] = READARG_STRINGS("alpha"),
+            },
+            .arg.bounds.inf = 1,
+        },
+    };
+    const char *args[] = {"-a", "--beta=x", "-c", "--alpha", "-by"};
+
+    struct readarg_parser rp;
+    readarg_parser_init(&rp, opts, 1, NULL, 0, (struct readarg_view_strings){.strings = args, .len = sizeof args / sizeof *args});
+    rp.capopts = sizeof opts / sizeof *opts;
+
+    struct readarg_index_slot slots[8];
+    struct readarg_index index;
+    if (indexed) {
+        readarg_index_init(&index, slots, sizeof slots / sizeof *slots);
+        if (readarg_index_add(&index, opts, rp.nopts) != READARG_ESUCCESS)
+            return 0;
+        rp.index = &index;
+    }
+
+    /* The options are added while parsing. */
+    if (!readarg_parse(&rp))
+        return 0;
+
+    /* The second option reuses "alpha", so neither of them may be added. */
+    struct readarg_opt plugin[] = {
+        {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("b"),
+                [READARG_FORM_LONG] = READARG_STRINGS("beta"),
+            },
+            .arg = {
+                .name = "value",
+                .bounds.inf = 1,
+            },
+        },
+        {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("c"),
+                [READARG_FORM_LONG] = READARG_STRINGS("alpha"),
+            },
+            .arg.bounds.inf = 1,
+        },
+    };
+    if (readarg_parser_add_opts(&rp, plugin, 2) != READARG_EDUPNAME || rp.nopts != 1 || rp.error != READARG_ESUCCESS)
+        return 0;
+    if (indexed && index.len != 2)
+        return 0;
+
+    plugin[1].names[READARG_FORM_LONG] = READARG_STRINGS("gamma");
+    if (readarg_parser_add_opts(&rp, plugin, 2) != READARG_ESUCCESS || rp.nopts != 3)
+        return 0;
+    if (indexed && index.len != 6)
+        return 0;
+
+    if (readarg_parser_add_opts(&rp, plugin, 2) != READARG_ENOSPACE || rp.nopts != 3)
+        return 0;
+
+    while (readarg_parse(&rp));
+    if (rp.error != READARG_ESUCCESS)
+        return 0;
+
+    struct readarg_view_strings beta = opts[1].arg.val;
+    return opts[0].arg.val.len == 2 && beta.len == 2 && !strcmp(beta.strings[0], "x") && !strcmp(beta.strings[1], "y") && opts[2].arg.val.len == 1;
+}
+
+static int check_map(int first) {
+    struct readarg_map_entry entries[4];
+    struct readarg_map map;
+    readarg_map_init(&map, entries, sizeof entries / sizeof *entries, first);
+
+    struct readarg_opt opts[] = {
+        {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("D"),
+            },
+            .arg = {
+                .name = "name=value",
+                .bounds.inf = 1,
+            },
+            .map = &map,
+        },
+    };
+    const char *args[] = {"-DCC=cc", "-D", "NDEBUG", "-DCFLAGS=", "-DCC=gcc"};
+
+    struct readarg_parser rp;
+    readarg_parser_init(&rp, opts, 1, NULL, 0, (struct readarg_view_strings){.strings = args, .len = sizeof args / sizeof *args});
+    while (readarg_parse(&rp));
+    if (rp.error != READARG_ESUCCESS || map.len != 3)
+        return 0;
+
+    const struct readarg_map_entry *cc = readarg_map_get(&map, "CC");
+    const struct readarg_map_entry *ndebug = readarg_map_get(&map, "NDEBUG");
+    const struct readarg_map_entry *cflags = readarg_map_get(&map, "CFLAGS");
+    if (!cc || !ndebug || !cflags || readarg_map_get(&map, "C") || readarg_map_get(&map, "LDFLAGS"))
+        return 0;
+    if (strcmp(cc->val, first ? "cc" : "gcc") || ndebug->val || strcmp(cflags->val, ""))
+        return 0;
+
+    /* A fourth key does not fit. */
+    const char *more[] = {"-DLDFLAGS=-s"};
+    opts[0].arg.val = (struct readarg_view_strings){0};
+    readarg_parser_init(&rp, opts, 1, NULL, 0, (struct readarg_view_strings){.strings = more, .len = 1});
+    while (readarg_parse(&rp));
+    return rp.error == READARG_ENOSPACE && !readarg_map_get(&map, "LDFLAGS");
+}
+
+static int check_tokenize(void) {
+    char line[] = "set --timeout=5 -v 'node 1' \"a \\\"b\\\"\" '' c\\ d\te\\\nf \\\n";
+    const char *expected[] = {"set", "--timeout=5", "-v", "node 1", "a \"b\"", "", "c d", "ef"};
+    const char *tokens[16];
+    struct readarg_view_strings view;
+
+    if (readarg_tokenize(line, tokens, sizeof tokens / sizeof *tokens, &view) != READARG_ESUCCESS || view.len != sizeof expected / sizeof *expected)
+        return 0;
+    for (size_t i = 0; i < view.len; i++)
+        if (strcmp(view.strings[i], expected[i]))
+            return 0;
+
+    struct readarg_opt opts[] = {
+        {
+            .names = {
+                [READARG_FORM_LONG] = READARG_STRINGS("timeout"),
+            },
+            .arg = {
+                .name = "seconds",
+                .bounds.inf = 1,
+            },
+        },
+        {
+            .names = {
+                [READARG_FORM_SHORT] = READARG_STRINGS("v"),
+            },
+            .arg.bounds.inf = 1,
+        },
+    };
+
+    /* The first token is the command itself. */
+    struct readarg_parser rp;
+    readarg_parser_init(&rp, opts, sizeof opts / sizeof *opts, NULL, 0, (struct readarg_view_strings){.strings = view.strings + 1, .len = view.len - 1});
+    while (readarg_parse(&rp));
+    if (rp.error != READARG_ESUCCESS || strcmp(opts[0].arg.val.strings[0], "5") || opts[1].arg.val.len != 1 || rp.state.curr.ioper.len != 5)
+        return 0;
+    for (size_t i = 0; i < rp.state.curr.ioper.len; i++)
+        if (strcmp(rp.state.curr.ioper.strings[i], expected[3 + i]))
+            return 0;
+
+    char unterminated[] = "set 'node 1";
+    if (readarg_tokenize(unterminated, tokens, sizeof tokens / sizeof *tokens, &view) != READARG_EQUOTE)
+        return 0;
+
+    char full[] = "a b c";
+    return readarg_tokenize(full, tokens, 2, &view) == READARG_ENOSPACE;
+}